@@ -111,7 +111,29 @@ fifo	1	1024	16	0	7	0	read06.trace
 lru	8	2048	64	3	5	37.5	read08.trace
 fifo	4	4096	64	2	3	40	write01.trace`;
 
+    // Per-set data from the instrumented simulator (cache_simulator.cpp built
+    // with -DCACHE_INSTRUMENTATION). Paste a "<trace>-<policy>-sets.csv" file here.
+    // Sample: read01.trace, 1KB direct-mapped, 64B blocks, LRU.
+    const rawSetData = `Set,Accesses,Misses,MissRate
+0,0,0,0.00
+1,0,0,0.00
+2,0,0,0.00
+3,0,0,0.00
+4,0,0,0.00
+5,0,0,0.00
+6,0,0,0.00
+7,0,0,0.00
+8,1,1,100.00
+9,4,2,50.00
+10,0,0,0.00
+11,0,0,0.00
+12,0,0,0.00
+13,0,0,0.00
+14,0,0,0.00
+15,0,0,0.00`;
+
     const [data, setData] = useState([]);
+    const [setStats, setSetStats] = useState([]);
 
     // Helper function to parse the raw data string
     const parseData = (data) => {
@@ -132,11 +154,27 @@ fifo	4	4096	64	2	3	40	write01.trace`;
         return parsed;
     };
 
+    // Helper function to parse the comma-separated per-set data
+    const parseSetData = (data) => {
+        const lines = data.trim().split('\n');
+        return lines.slice(1).map(line => {
+            const [set, accesses, misses, missRate] = line.split(',').map(v => parseFloat(v.trim()));
+            return { Set: set, Accesses: accesses, Misses: misses, MissRate: missRate };
+        });
+    };
+
     // Parse data on component mount
     useEffect(() => {
         setData(parseData(rawData));
+        setSetStats(parseSetData(rawSetData));
     }, []);
 
+    // Shade each set by its share of the busiest set's misses
+    const heatmapColor = (misses, maxMisses) => {
+        const intensity = maxMisses > 0 ? misses / maxMisses : 0;
+        return `rgba(225, 87, 89, ${0.08 + 0.92 * intensity})`;
+    };
+
     // Filter and prepare data for the four charts
     const plot1Data = () => {
         const datasets = {};
@@ -297,6 +335,8 @@ fifo	4	4096	64	2	3	40	write01.trace`;
         }
     };
 
+    const maxSetMisses = setStats.reduce((max, d) => Math.max(max, d.Misses), 0);
+
     // Check if data is loaded before rendering charts
     if (data.length === 0) {
         return <div className="text-center p-8 text-xl font-semibold">Loading charts...</div>;
@@ -391,6 +431,23 @@ fifo	4	4096	64	2	3	40	write01.trace`;
                         </div>
                     </div>
                 </div>
+
+                {/* Heatmap: misses per cache set */}
+                <div className="bg-white rounded-xl shadow-lg p-6 mt-10">
+                    <h2 className="text-2xl font-bold text-center mb-6">Set Heatmap: Misses per Cache Set</h2>
+                    <div className="grid gap-1" style={{ gridTemplateColumns: `repeat(${Math.min(32, Math.max(1, setStats.length))}, minmax(0, 1fr))` }}>
+                        {setStats.map(s => (
+                            <div
+                                key={s.Set}
+                                className="h-8 rounded text-xs flex items-center justify-center"
+                                style={{ backgroundColor: heatmapColor(s.Misses, maxSetMisses) }}
+                                title={`Set ${s.Set}: ${s.Accesses} accesses, ${s.Misses} misses (${s.MissRate.toFixed(2)}%)`}
+                            >
+                                {s.Set}
+                            </div>
+                        ))}
+                    </div>
+                </div>
             </div>
         </div>
     );
@@ -74,6 +74,97 @@ while (newfile >> access_type_str >> address_hex >> size_str) {
 #include <list>
 #include <sstream>
 
+/*
+* Optional hot-path instrumentation. Compile with -DCACHE_INSTRUMENTATION to
+* record per-set access/miss counts, the most frequently evicted blocks and
+* eviction-to-reuse distances. Without the flag none of this code is compiled,
+* so the normal build pays nothing for it.
+*/
+#ifdef CACHE_INSTRUMENTATION
+#include <unordered_map>
+#include <algorithm>
+
+// Number of blocks tracked by the SpaceSaving top-K eviction sketch
+const unsigned int TOP_EVICTED_BLOCKS = 32;
+
+// A struct to hold one entry of the SpaceSaving sketch
+struct EvictedBlock {
+    unsigned long block_address = 0;
+    unsigned long evictions = 0;
+    unsigned long error = 0; // Upper bound on how much 'evictions' is overestimated
+};
+
+// Collects the per-set and per-block statistics for one Cache
+class CacheInstrumentation {
+private:
+    std::vector<unsigned long> set_accesses;
+    std::vector<unsigned long> set_misses;
+    std::vector<EvictedBlock> top_evicted;
+    // Access number at which each not-yet-reused block was evicted
+    std::unordered_map<unsigned long, unsigned long> evicted_at;
+    // reuse_histogram[i] counts reuse distances in [2^i, 2^(i+1)) accesses
+    std::vector<unsigned long> reuse_histogram;
+    unsigned long access_count = 0;
+
+public:
+    void resize(unsigned int num_sets) {
+        set_accesses.assign(num_sets, 0);
+        set_misses.assign(num_sets, 0);
+        reuse_histogram.assign(64, 0);
+    }
+
+    void record_access(unsigned long index) {
+        access_count++;
+        set_accesses[index]++;
+    }
+
+    void record_miss(unsigned long index, unsigned long block_address) {
+        set_misses[index]++;
+        auto it = evicted_at.find(block_address);
+        if (it != evicted_at.end()) {
+            unsigned long distance = access_count - it->second;
+            unsigned int bucket = 0;
+            while ((distance >> (bucket + 1)) != 0) bucket++;
+            reuse_histogram[bucket]++;
+            evicted_at.erase(it);
+        }
+    }
+
+    // SpaceSaving: keep K counters; an untracked block replaces the smallest one
+    void record_eviction(unsigned long block_address) {
+        evicted_at[block_address] = access_count;
+
+        size_t smallest = 0;
+        for (size_t i = 0; i < top_evicted.size(); ++i) {
+            if (top_evicted[i].block_address == block_address) {
+                top_evicted[i].evictions++;
+                return;
+            }
+            if (top_evicted[i].evictions < top_evicted[smallest].evictions) smallest = i;
+        }
+        if (top_evicted.size() < TOP_EVICTED_BLOCKS) {
+            top_evicted.push_back({ block_address, 1, 0 });
+        }
+        else {
+            unsigned long smallest_count = top_evicted[smallest].evictions;
+            top_evicted[smallest] = { block_address, smallest_count + 1, smallest_count };
+        }
+    }
+
+    std::vector<EvictedBlock> get_top_evicted() const {
+        std::vector<EvictedBlock> sorted = top_evicted;
+        std::sort(sorted.begin(), sorted.end(),
+            [](const EvictedBlock& a, const EvictedBlock& b) { return a.evictions > b.evictions; });
+        return sorted;
+    }
+
+    const std::vector<unsigned long>& get_set_accesses() const { return set_accesses; }
+    const std::vector<unsigned long>& get_set_misses() const { return set_misses; }
+    const std::vector<unsigned long>& get_reuse_histogram() const { return reuse_histogram; }
+    unsigned long get_never_reused() const { return evicted_at.size(); }
+};
+#endif
+
  // A struct to represent a single cache block
 struct CacheBlock {
     bool valid = false;
@@ -108,6 +199,10 @@ private:
     unsigned long reads = 0;
     unsigned long writes = 0;
 
+#ifdef CACHE_INSTRUMENTATION
+    CacheInstrumentation instrumentation;
+#endif
+
 public:
     // Constructor to initialize the cache and its parameters
     Cache(unsigned int cs, unsigned int bs, unsigned int assoc, const std::string& rp)
@@ -124,6 +219,9 @@ public:
         // Resize the cache to the correct dimensions
         cache.resize(num_sets, std::vector<CacheBlock>(associativity));
         replacement_queues.resize(num_sets);
+#ifdef CACHE_INSTRUMENTATION
+        instrumentation.resize(num_sets);
+#endif
 
         std::cout << "Cache Size: " << cache_size << " bytes\n";
         std::cout << "Block Size: " << block_size << " bytes\n";
@@ -153,6 +251,9 @@ public:
         // Extract the tag and index from the address
         unsigned long tag = address >> (index_bits + offset_bits);
         unsigned long index = (address >> offset_bits) & ((1 << index_bits) - 1);
+#ifdef CACHE_INSTRUMENTATION
+        instrumentation.record_access(index);
+#endif
 
         // Check the current set for a cache hit
         bool hit = false;
@@ -174,6 +275,9 @@ public:
         }
         else {
             misses++;
+#ifdef CACHE_INSTRUMENTATION
+            instrumentation.record_miss(index, address >> offset_bits);
+#endif
 
             // Find an empty slot
             bool found_empty_slot = false;
@@ -208,6 +312,10 @@ public:
                     replacement_queues[index].push_back(tag);
                 }
 
+#ifdef CACHE_INSTRUMENTATION
+                instrumentation.record_eviction((tag_to_evict << index_bits) | index);
+#endif
+
                 // Find the cache block with the tag to be evicted and replace it
                 for (int i = 0; i < associativity; ++i) {
                     if (cache[index][i].tag == tag_to_evict) {
@@ -239,9 +347,24 @@ public:
             std::cout << "Hit Rate: 0.00%\n";
             std::cout << "Miss Rate: 0.00%\n";
         }
+#ifdef CACHE_INSTRUMENTATION
+        std::cout << "Most Evicted Blocks:\n";
+        std::vector<EvictedBlock> top = instrumentation.get_top_evicted();
+        for (size_t i = 0; i < top.size() && i < 5; ++i) {
+            std::cout << "  0x" << std::hex << (top[i].block_address << offset_bits) << std::dec
+                << " (set " << (top[i].block_address & ((1UL << index_bits) - 1)) << "): "
+                << top[i].evictions << " evictions\n";
+        }
+#endif
         std::cout << "------------------------------------\n";
     }
 
+#ifdef CACHE_INSTRUMENTATION
+    const CacheInstrumentation& get_instrumentation() const { return instrumentation; }
+    unsigned int get_index_bits() const { return index_bits; }
+    unsigned int get_offset_bits() const { return offset_bits; }
+#endif
+
     // New method to retrieve hits and misses for export
     CacheResults get_results() const {
         double hit_rate = 0.0;
@@ -280,6 +403,47 @@ void exportResultsToCSV(const std::string& filename_base, const Cache& cache_sim
     std::cout << "Simulation results exported to " << output_filename << "\n";
 }
 
+#ifdef CACHE_INSTRUMENTATION
+// Function to export the instrumentation data next to the results CSV. The
+// "-sets.csv" file is the input for the set heatmap in Graphs/React Graph.jsx.
+void exportInstrumentationToCSV(const std::string& filename_base, const Cache& cache_simulator) {
+    std::string prefix = filename_base + "-" + cache_simulator.get_replacement_policy();
+    const CacheInstrumentation& stats = cache_simulator.get_instrumentation();
+
+    std::ofstream sets_file(prefix + "-sets.csv", std::ios_base::trunc);
+    sets_file << "Set,Accesses,Misses,MissRate\n";
+    const std::vector<unsigned long>& accesses = stats.get_set_accesses();
+    const std::vector<unsigned long>& set_misses = stats.get_set_misses();
+    for (size_t set = 0; set < accesses.size(); ++set) {
+        double miss_rate = accesses[set] > 0 ? (double)set_misses[set] / accesses[set] * 100 : 0.0;
+        sets_file << set << "," << accesses[set] << "," << set_misses[set] << ","
+            << std::fixed << std::setprecision(2) << miss_rate << "\n";
+    }
+    sets_file.close();
+
+    std::ofstream evicted_file(prefix + "-evicted.csv", std::ios_base::trunc);
+    evicted_file << "Rank,BlockAddress,Set,Evictions,MaxOvercount\n";
+    std::vector<EvictedBlock> top = stats.get_top_evicted();
+    for (size_t i = 0; i < top.size(); ++i) {
+        evicted_file << (i + 1) << ",0x" << std::hex << (top[i].block_address << cache_simulator.get_offset_bits())
+            << std::dec << "," << (top[i].block_address & ((1UL << cache_simulator.get_index_bits()) - 1))
+            << "," << top[i].evictions << "," << top[i].error << "\n";
+    }
+    evicted_file.close();
+
+    std::ofstream reuse_file(prefix + "-reuse.csv", std::ios_base::trunc);
+    reuse_file << "MinDistance,MaxDistance,Reuses\n";
+    const std::vector<unsigned long>& histogram = stats.get_reuse_histogram();
+    for (size_t bucket = 0; bucket < histogram.size(); ++bucket) {
+        if (histogram[bucket] == 0) continue;
+        reuse_file << (1ULL << bucket) << "," << ((1ULL << bucket) * 2 - 1) << "," << histogram[bucket] << "\n";
+    }
+    reuse_file << "never,never," << stats.get_never_reused() << "\n";
+    reuse_file.close();
+
+    std::cout << "Instrumentation exported to " << prefix << "-sets.csv, -evicted.csv and -reuse.csv\n";
+}
+#endif
 
 // Main function to run the simulator
 int main() {
@@ -329,6 +493,9 @@ int main() {
 
     // Export the final results to the CSV file
     exportResultsToCSV(filename, cache_simulator);
+#ifdef CACHE_INSTRUMENTATION
+    exportInstrumentationToCSV(filename, cache_simulator);
+#endif
 
     return 0;
 }
@@ -18,11 +18,14 @@
 #include <list>
 #include <sstream>
 #include <cstdlib> // Required for the system() function
+#include <unordered_map>
+#include <algorithm>
 
  // A struct to represent a single cache block
 struct CacheBlock {
     bool valid = false;
     unsigned long tag = 0;
+    unsigned int owner = 0; // Tenant that filled the block
 };
 
 // A struct to hold the simulation results
@@ -32,6 +35,17 @@ struct CacheResults {
     double hit_rate = 0.0;
 };
 
+// A struct to hold the results of one tenant in a shared cache
+struct TenantResults {
+    unsigned long hits = 0;
+    unsigned long misses = 0;
+    double hit_rate = 0.0;
+    unsigned long occupancy = 0; // Valid blocks owned by the tenant at the end of the run
+};
+
+// Tenant IDs must be below this limit, which matches the width of a way mask
+const unsigned int MAX_TENANTS = 64;
+
 // A helper function to check if a number is a power of two
 bool isPowerOfTwo(unsigned int n) {
     if (n == 0) return false;
@@ -58,6 +72,12 @@ private:
     unsigned long reads = 0;
     unsigned long writes = 0;
 
+    // Way allocation (CAT-style partitioning): bit i of way_masks[t] allows
+    // tenant t to fill way i. Hits may come from any way. Tenants without a
+    // mask may fill every way.
+    std::vector<unsigned long long> way_masks;
+    std::vector<TenantResults> tenant_stats;
+
     bool is_valid = true;
 
 public:
@@ -116,6 +136,7 @@ public:
             // Resize the cache and replacement queues based on the calculated number of sets and associativity.
             cache.resize(num_sets, std::vector<CacheBlock>(associativity));
             replacement_queues.resize(num_sets);
+            tenant_stats.resize(MAX_TENANTS);
         }
         catch (const std::exception& e) {
             std::cerr << "Error during Cache initialization: " << e.what() << "\n";
@@ -127,9 +148,35 @@ public:
         return is_valid;
     }
 
-    // Access method to simulate a read or write operation
-    void access(char op, unsigned long address) {
+    // Sets the per-tenant fill masks; an empty list disables partitioning
+    void set_way_masks(const std::vector<unsigned long long>& masks) {
         if (!is_valid) return;
+        if (masks.size() > MAX_TENANTS) {
+            std::cerr << "Error: Way masks can be given for at most " << MAX_TENANTS << " tenants.\n";
+            is_valid = false;
+            return;
+        }
+        if (!masks.empty() && associativity > 64) {
+            std::cerr << "Error: Way masks support at most 64 ways, but the cache is "
+                << associativity << "-way.\n";
+            is_valid = false;
+            return;
+        }
+        for (size_t t = 0; t < masks.size(); ++t) {
+            unsigned long long all_ways = (associativity >= 64) ? ~0ULL : ((1ULL << associativity) - 1);
+            if ((masks[t] & all_ways) == 0 || (masks[t] & ~all_ways) != 0) {
+                std::cerr << "Error: Way mask 0x" << std::hex << masks[t] << std::dec << " of tenant " << t
+                    << " must select at least one of the cache's " << associativity << " ways and no others.\n";
+                is_valid = false;
+                return;
+            }
+        }
+        way_masks = masks;
+    }
+
+    // Access method to simulate a read or write operation by a tenant
+    void access(char op, unsigned long address, unsigned int tenant = 0) {
+        if (!is_valid || tenant >= MAX_TENANTS) return;
 
         // Count reads and writes
         if (op == 's') {
@@ -149,6 +196,9 @@ public:
         bool hit = false;
         int hit_index = -1;
 
+        const bool partitioned = tenant < way_masks.size();
+        const unsigned long long fill_mask = partitioned ? way_masks[tenant] : 0;
+
         // Check for a cache hit
         for (int i = 0; i < associativity; ++i) {
             if (cache[index][i].valid && cache[index][i].tag == tag) {
@@ -160,6 +210,7 @@ public:
 
         if (hit) {
             hits++;
+            tenant_stats[tenant].hits++;
             if (replacement_policy == "lru") {
                 replacement_queues[index].remove(tag);
                 replacement_queues[index].push_front(tag);
@@ -167,11 +218,12 @@ public:
         }
         else {
             misses++;
+            tenant_stats[tenant].misses++;
 
             bool found_empty_slot = false;
             int empty_slot_index = -1;
             for (int i = 0; i < associativity; ++i) {
-                if (!cache[index][i].valid) {
+                if (!cache[index][i].valid && (!partitioned || ((fill_mask >> i) & 1))) {
                     empty_slot_index = i;
                     found_empty_slot = true;
                     break;
@@ -181,6 +233,7 @@ public:
             if (found_empty_slot) {
                 cache[index][empty_slot_index].valid = true;
                 cache[index][empty_slot_index].tag = tag;
+                cache[index][empty_slot_index].owner = tenant;
                 if (replacement_policy == "lru") {
                     replacement_queues[index].push_front(tag);
                 }
@@ -188,6 +241,46 @@ public:
                     replacement_queues[index].push_back(tag);
                 }
             }
+            else if (partitioned) {
+                // Evict the block nearest the eviction end of the queue (least
+                // recently used for LRU, oldest for FIFO) among the ways this
+                // tenant may fill
+                std::list<unsigned long>& queue = replacement_queues[index];
+                auto victim = queue.end();
+                int victim_way = -1;
+                auto allowedWay = [&](unsigned long candidate_tag) {
+                    for (unsigned int i = 0; i < associativity; ++i) {
+                        if (cache[index][i].valid && cache[index][i].tag == candidate_tag) {
+                            return ((fill_mask >> i) & 1) ? static_cast<int>(i) : -1;
+                        }
+                    }
+                    return -1;
+                };
+                if (replacement_policy == "lru") {
+                    for (auto it = queue.end(); it != queue.begin() && victim_way < 0;) {
+                        --it;
+                        victim_way = allowedWay(*it);
+                        victim = it;
+                    }
+                }
+                else if (replacement_policy == "fifo") {
+                    for (auto it = queue.begin(); it != queue.end() && victim_way < 0; ++it) {
+                        victim_way = allowedWay(*it);
+                        victim = it;
+                    }
+                }
+                if (victim_way < 0) return;
+
+                queue.erase(victim);
+                if (replacement_policy == "lru") {
+                    queue.push_front(tag);
+                }
+                else {
+                    queue.push_back(tag);
+                }
+                cache[index][victim_way].tag = tag;
+                cache[index][victim_way].owner = tenant;
+            }
             else {
                 unsigned long tag_to_evict;
                 if (replacement_policy == "lru") {
@@ -204,6 +297,7 @@ public:
                 for (int i = 0; i < associativity; ++i) {
                     if (cache[index][i].tag == tag_to_evict) {
                         cache[index][i].tag = tag;
+                        cache[index][i].owner = tenant;
                         break;
                     }
                 }
@@ -220,6 +314,27 @@ public:
         return { hits, misses, hit_rate };
     }
 
+    // Method to retrieve the per-tenant results, including final occupancy
+    std::vector<TenantResults> get_tenant_results() const {
+        std::vector<TenantResults> results = tenant_stats;
+        for (const auto& set : cache) {
+            for (const auto& block : set) {
+                if (block.valid) results[block.owner].occupancy++;
+            }
+        }
+        // Only report tenants up to the highest one that was seen
+        while (!results.empty() && results.back().hits + results.back().misses == 0
+            && results.back().occupancy == 0) {
+            results.pop_back();
+        }
+        for (auto& tenant : results) {
+            if (tenant.hits + tenant.misses > 0) {
+                tenant.hit_rate = (double)tenant.hits / (tenant.hits + tenant.misses) * 100;
+            }
+        }
+        return results;
+    }
+
     // Getter methods for the parameters
     unsigned int get_cache_size() const { return cache_size; }
     unsigned int get_associativity() const { return associativity; }
@@ -227,18 +342,302 @@ public:
     const std::string& get_replacement_policy() const { return replacement_policy; }
 };
 
-// Function to write a single result row to a CSV file
-void writeResultToCSV(std::ofstream& file, const Cache& cache_simulator, const std::string& trace_filename) {
-    const CacheResults results = cache_simulator.get_results();
-    file << cache_simulator.get_replacement_policy() << ","
-        << cache_simulator.get_associativity() << ","
-        << cache_simulator.get_cache_size() << ","
-        << cache_simulator.get_block_size() << ","
-        << results.hits << ","
-        << results.misses << ","
-        << std::fixed << std::setprecision(2) << results.hit_rate << ","
-        << trace_filename << "\n";
-}
+// A struct to hold the settings of the virtual-to-physical translation stage.
+// The defaults (4 KB pages, identity mapping, physical indexing) leave the
+// addresses seen by the cache unchanged, so only the TLB statistics are added.
+struct TranslationConfig {
+    unsigned int page_size = 4096;           // 4096 (4 KB), 2097152 (2 MB) or 1073741824 (1 GB)
+    std::string mapping_policy = "identity"; // 'identity', 'random' or 'coloring'
+    std::string index_mode = "physical";     // 'physical' or 'virtual'
+    unsigned int l1_tlb_entries = 64;
+    unsigned int l1_tlb_associativity = 4;
+    unsigned int l2_tlb_entries = 1536;
+    unsigned int l2_tlb_associativity = 12;
+    unsigned int physical_address_bits = 32; // Frame range for 'random'/'coloring'; 'identity' keeps the page number
+    unsigned long seed = 1;                  // Seed for the 'random' and 'coloring' frame allocators
+};
+
+// A struct to hold the translation statistics
+struct TranslationResults {
+    unsigned long l1_tlb_hits = 0;
+    unsigned long l1_tlb_misses = 0;
+    unsigned long l2_tlb_hits = 0;
+    unsigned long l2_tlb_misses = 0;
+    unsigned long page_walks = 0;
+};
+
+// A flat, open-addressing hash map from virtual page number to physical frame
+// number. Slots are stored in two parallel vectors and grow by doubling, so a
+// lookup never allocates and an insert only allocates when the table is resized.
+class PageTable {
+private:
+    std::vector<unsigned long> keys;   // Virtual page number + 1, 0 marks an empty slot
+    std::vector<unsigned long> frames;
+    size_t mask;
+    size_t count = 0;
+
+    static size_t hashPage(unsigned long vpn) {
+        unsigned long long h = vpn;
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return static_cast<size_t>(h);
+    }
+
+    void grow() {
+        std::vector<unsigned long> old_keys;
+        std::vector<unsigned long> old_frames;
+        old_keys.swap(keys);
+        old_frames.swap(frames);
+        keys.assign(old_keys.size() * 2, 0);
+        frames.assign(old_keys.size() * 2, 0);
+        mask = keys.size() - 1;
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == 0) continue;
+            size_t slot = hashPage(old_keys[i] - 1) & mask;
+            while (keys[slot] != 0) slot = (slot + 1) & mask;
+            keys[slot] = old_keys[i];
+            frames[slot] = old_frames[i];
+        }
+    }
+
+public:
+    explicit PageTable(size_t initial_capacity = 1 << 16) {
+        size_t capacity = 16;
+        while (capacity < initial_capacity) capacity <<= 1;
+        keys.assign(capacity, 0);
+        frames.assign(capacity, 0);
+        mask = capacity - 1;
+    }
+
+    // Returns the frame slot for 'vpn', creating it if necessary. 'inserted'
+    // tells the caller that the slot is new and its frame must be assigned.
+    unsigned long& findOrInsert(unsigned long vpn, bool& inserted) {
+        // Keep the load factor at or below one half so probe chains stay short
+        if ((count + 1) * 2 > keys.size()) grow();
+        size_t slot = hashPage(vpn) & mask;
+        while (keys[slot] != 0) {
+            if (keys[slot] == vpn + 1) {
+                inserted = false;
+                return frames[slot];
+            }
+            slot = (slot + 1) & mask;
+        }
+        keys[slot] = vpn + 1;
+        count++;
+        inserted = true;
+        return frames[slot];
+    }
+
+    size_t size() const { return count; }
+};
+
+// A set-associative, LRU-managed TLB mapping virtual page numbers to frames.
+// Each way keeps a last-used timestamp instead of a list so lookups never allocate.
+class Tlb {
+private:
+    unsigned int associativity;
+    unsigned int num_sets;
+    std::vector<unsigned long> tags;      // Virtual page number + 1, 0 marks an invalid entry
+    std::vector<unsigned long> frames;
+    std::vector<unsigned long> last_used;
+    unsigned long clock = 0;
+
+public:
+    unsigned long hits = 0;
+    unsigned long misses = 0;
+
+    Tlb(unsigned int entries, unsigned int assoc)
+        : associativity(assoc), num_sets(entries / assoc),
+          tags(entries, 0), frames(entries, 0), last_used(entries, 0) {}
+
+    bool lookup(unsigned long vpn, unsigned long& frame) {
+        size_t base = (vpn % num_sets) * associativity;
+        for (unsigned int i = 0; i < associativity; ++i) {
+            if (tags[base + i] == vpn + 1) {
+                last_used[base + i] = ++clock;
+                frame = frames[base + i];
+                hits++;
+                return true;
+            }
+        }
+        misses++;
+        return false;
+    }
+
+    void fill(unsigned long vpn, unsigned long frame) {
+        size_t base = (vpn % num_sets) * associativity;
+        // Invalid entries have a timestamp of 0, so they are always chosen first
+        size_t victim = base;
+        for (size_t i = base + 1; i < base + associativity; ++i) {
+            if (last_used[i] < last_used[victim]) victim = i;
+        }
+        tags[victim] = vpn + 1;
+        frames[victim] = frame;
+        last_used[victim] = ++clock;
+    }
+};
+
+// Translates trace (virtual) addresses through a two-level TLB and a
+// synthetic page table before they reach the Cache.
+class AddressTranslator {
+private:
+    TranslationConfig config;
+    Tlb l1_tlb;
+    Tlb l2_tlb;
+    PageTable page_table;
+
+    unsigned int page_bits = 0;
+    unsigned int frame_bits = 0;
+    unsigned int color_bits = 0;
+    unsigned long long next_frame = 0;
+    std::vector<unsigned long long> next_frame_per_color;
+    unsigned long page_walks = 0;
+    bool virtually_indexed = false;
+
+    bool is_valid = true;
+
+    // A seeded bijection on [0, 2^bits), used to hand out frames in a
+    // scattered but collision-free order.
+    unsigned long long scramble(unsigned long long x, unsigned int bits) const {
+        unsigned long long range_mask = (bits >= 64) ? ~0ULL : ((1ULL << bits) - 1);
+        unsigned long long h = (x + config.seed) & range_mask;
+        h = (h * 0x9e3779b97f4a7c15ULL) & range_mask;
+        h ^= h >> ((bits + 1) / 2);
+        h = (h * 0xbf58476d1ce4e5b9ULL) & range_mask;
+        return h;
+    }
+
+    // Picks the frame for a newly touched page. Returns false once 'random'
+    // or 'coloring' has handed out every frame of the physical address range
+    // (or of the page's color), rather than silently reusing frames.
+    bool allocateFrame(unsigned long vpn, unsigned long& frame) {
+        if (config.mapping_policy == "random") {
+            if (next_frame >> frame_bits != 0) return false;
+            frame = static_cast<unsigned long>(scramble(next_frame++, frame_bits));
+            return true;
+        }
+        if (config.mapping_policy == "coloring") {
+            // Keep the page color (the page-number bits that overlap the
+            // cache index) equal between the virtual and physical page
+            unsigned long long color = vpn & ((1ULL << color_bits) - 1);
+            if (next_frame_per_color[color] >> (frame_bits - color_bits) != 0) return false;
+            unsigned long long slot = scramble(next_frame_per_color[color]++, frame_bits - color_bits);
+            frame = static_cast<unsigned long>((slot << color_bits) | color);
+            return true;
+        }
+        frame = vpn; // identity
+        return true;
+    }
+
+public:
+    AddressTranslator(const TranslationConfig& cfg, unsigned int cache_size, unsigned int associativity)
+        : config(cfg),
+          l1_tlb(cfg.l1_tlb_entries, cfg.l1_tlb_associativity == 0 ? 1 : cfg.l1_tlb_associativity),
+          l2_tlb(cfg.l2_tlb_entries, cfg.l2_tlb_associativity == 0 ? 1 : cfg.l2_tlb_associativity) {
+
+        if (config.page_size != 4096 && config.page_size != 2097152 && config.page_size != 1073741824) {
+            std::cerr << "Error: Page size must be 4096 (4 KB), 2097152 (2 MB) or 1073741824 (1 GB).\n";
+            is_valid = false;
+            return;
+        }
+        if (config.mapping_policy != "identity" && config.mapping_policy != "random"
+            && config.mapping_policy != "coloring") {
+            std::cerr << "Error: Page mapping policy must be 'identity', 'random' or 'coloring'.\n";
+            is_valid = false;
+            return;
+        }
+        if (config.index_mode != "physical" && config.index_mode != "virtual") {
+            std::cerr << "Error: Cache index mode must be 'physical' or 'virtual'.\n";
+            is_valid = false;
+            return;
+        }
+        if (config.l1_tlb_entries == 0 || config.l1_tlb_associativity == 0
+            || config.l1_tlb_entries % config.l1_tlb_associativity != 0
+            || config.l2_tlb_entries == 0 || config.l2_tlb_associativity == 0
+            || config.l2_tlb_entries % config.l2_tlb_associativity != 0) {
+            std::cerr << "Error: TLB entries must be a non-zero multiple of the TLB associativity.\n";
+            is_valid = false;
+            return;
+        }
+
+        virtually_indexed = (config.index_mode == "virtual");
+        page_bits = static_cast<unsigned int>(log2(config.page_size));
+        if (config.mapping_policy != "identity") {
+            if (config.physical_address_bits < page_bits) {
+                std::cerr << "Error: Physical address width (" << config.physical_address_bits
+                    << " bits) cannot hold a single " << config.page_size << "-byte page.\n";
+                is_valid = false;
+                return;
+            }
+            // Physical addresses are handed to Cache as unsigned long
+            if (config.physical_address_bits > 8 * sizeof(unsigned long)) {
+                std::cerr << "Error: Physical address width (" << config.physical_address_bits
+                    << " bits) exceeds the " << 8 * sizeof(unsigned long) << "-bit addresses used by the cache.\n";
+                is_valid = false;
+                return;
+            }
+            frame_bits = config.physical_address_bits - page_bits;
+        }
+
+        // Number of page colors = bytes per cache way / page size
+        unsigned int way_size = cache_size / associativity;
+        while (color_bits < frame_bits && (static_cast<unsigned long long>(config.page_size) << color_bits) < way_size) {
+            color_bits++;
+        }
+        if (config.mapping_policy == "coloring") {
+            next_frame_per_color.assign(1ULL << color_bits, 0);
+        }
+    }
+
+    // Also false after a run that exhausted the physical frames
+    bool is_translator_valid() const {
+        return is_valid;
+    }
+
+    // Translates a virtual address and returns the address used to index and
+    // tag the cache: the physical address, or the original virtual address
+    // when the cache is virtually indexed.
+    unsigned long translate(unsigned long virtual_address) {
+        unsigned long vpn = virtual_address >> page_bits;
+        unsigned long frame = 0;
+        if (!l1_tlb.lookup(vpn, frame)) {
+            if (!l2_tlb.lookup(vpn, frame)) {
+                // Page walk: frames are assigned on first touch (demand paging)
+                page_walks++;
+                bool inserted = false;
+                unsigned long& entry = page_table.findOrInsert(vpn, inserted);
+                if (inserted && !allocateFrame(vpn, entry)) {
+                    if (is_valid) {
+                        std::cerr << "Error: The '" << config.mapping_policy << "' mapping ran out of physical frames ("
+                            << config.physical_address_bits << "-bit physical addresses, "
+                            << config.page_size << "-byte pages).\n";
+                    }
+                    is_valid = false;
+                    entry = vpn;
+                }
+                frame = entry;
+                l2_tlb.fill(vpn, frame);
+            }
+            l1_tlb.fill(vpn, frame);
+        }
+
+        if (virtually_indexed) {
+            return virtual_address;
+        }
+        unsigned long page_offset = virtual_address & ((1UL << page_bits) - 1);
+        // The frame fits: identity keeps the page number of an unsigned long
+        // address, and the other policies stay within physical_address_bits
+        return (frame << page_bits) | page_offset;
+    }
+
+    TranslationResults get_results() const {
+        return { l1_tlb.hits, l1_tlb.misses, l2_tlb.hits, l2_tlb.misses,
+                 page_walks };
+    }
+
+    const TranslationConfig& get_config() const { return config; }
+};
 
 // Struct to hold a single test case
 struct TestCase {
@@ -247,10 +646,697 @@ struct TestCase {
     unsigned int associativity;
     std::string replacement_policy;
     std::string trace_filename;
+    TranslationConfig translation = {};
+    std::vector<unsigned long long> way_masks = {}; // Per-tenant fill masks; empty = unpartitioned
+};
+
+// A struct to hold everything measured for one test case
+struct SimulationRecord {
+    CacheResults cache;
+    TranslationResults translation;
+    std::vector<TenantResults> tenants;
+};
+
+// Formats the way masks as "0x0f;0xf0", or "all" when the cache is unpartitioned
+std::string formatWayMasks(const std::vector<unsigned long long>& way_masks) {
+    if (way_masks.empty()) return "all";
+    std::stringstream text;
+    for (size_t t = 0; t < way_masks.size(); ++t) {
+        if (t > 0) text << ";";
+        text << "0x" << std::hex << way_masks[t];
+    }
+    return text.str();
+}
+
+// Function to write a single result row to a CSV file
+void writeResultToCSV(std::ofstream& file, const TestCase& test_case, const SimulationRecord& record) {
+    file << test_case.replacement_policy << ","
+        << test_case.associativity << ","
+        << test_case.cache_size << ","
+        << test_case.block_size << ","
+        << record.cache.hits << ","
+        << record.cache.misses << ","
+        << std::fixed << std::setprecision(2) << record.cache.hit_rate << ","
+        << test_case.trace_filename << ","
+        << test_case.translation.page_size << ","
+        << test_case.translation.mapping_policy << ","
+        << test_case.translation.index_mode << ","
+        << record.translation.l1_tlb_hits << ","
+        << record.translation.l1_tlb_misses << ","
+        << record.translation.l2_tlb_hits << ","
+        << record.translation.l2_tlb_misses << ","
+        << record.translation.page_walks << ","
+        << formatWayMasks(test_case.way_masks) << "\n";
+}
+
+// Function to write one row per active tenant to the per-tenant CSV file
+void writeTenantResultsToCSV(std::ofstream& file, const TestCase& test_case, const SimulationRecord& record) {
+    for (size_t t = 0; t < record.tenants.size(); ++t) {
+        const TenantResults& tenant = record.tenants[t];
+        if (tenant.hits + tenant.misses == 0 && tenant.occupancy == 0) continue;
+        file << test_case.replacement_policy << ","
+            << test_case.associativity << ","
+            << test_case.cache_size << ","
+            << test_case.block_size << ","
+            << test_case.trace_filename << ","
+            << t << ",";
+        if (t < test_case.way_masks.size()) {
+            file << "0x" << std::hex << test_case.way_masks[t] << std::dec << ",";
+        }
+        else {
+            file << "all,";
+        }
+        file << tenant.hits << ","
+            << tenant.misses << ","
+            << std::fixed << std::setprecision(2) << tenant.hit_rate << ","
+            << tenant.occupancy << "\n";
+    }
+}
+
+/*
+ * Incremental result store. Every simulated test case is appended to
+ * Exports/result_store.csv under a key made of the trace content hash, the
+ * full configuration and SIMULATOR_VERSION. Later runs reuse any stored
+ * result whose key still matches, so only new or changed rows (or rows
+ * whose trace file changed) are simulated again. Delete the store file to
+ * force a full re-run.
+ */
+const std::string RESULT_STORE_PATH = "Exports/result_store.csv";
+
+// Bump this whenever Cache or AddressTranslator behaviour changes so that
+// results produced by an older simulator are not reused.
+const unsigned int SIMULATOR_VERSION = 4;
+
+// A single load or store read from a trace file
+struct TraceAccess {
+    char op;
+    unsigned long address;
+    unsigned int tenant = 0; // Optional fourth trace column, below MAX_TENANTS
 };
 
+// The parsed accesses of one trace file and the hash of its contents
+struct LoadedTrace {
+    std::string filename;
+    unsigned long long hash = 0;
+    std::vector<TraceAccess> accesses;
+};
+
+// 64-bit FNV-1a, used to fingerprint trace contents and workload specs
+const unsigned long long FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+
+unsigned long long hashBytes(unsigned long long hash, const char* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Reads a trace file once, hashing its raw contents while parsing the
+// accesses. Lines are "<l|s> <hex address> <size> [tenant]"; the tenant
+// column is decimal, defaults to 0 and must be below MAX_TENANTS. Returns
+// false if the file cannot be opened.
+bool loadTrace(const std::string& filename, LoadedTrace& trace) {
+    std::ifstream trace_file(filename);
+    if (!trace_file.is_open()) {
+        return false;
+    }
+
+    trace.filename = filename;
+    trace.hash = FNV_OFFSET_BASIS;
+    trace.accesses.clear();
+
+    char op;
+    unsigned long address;
+    unsigned int size;
+    std::string line;
+    unsigned int lines_read = 0;
+    while (std::getline(trace_file, line)) {
+        lines_read++;
+        trace.hash = hashBytes(trace.hash, line.data(), line.size());
+        trace.hash = hashBytes(trace.hash, "\n", 1);
+
+        if (line.empty()) continue;
+        std::stringstream ss(line);
+        ss >> op >> std::hex >> address >> size;
+        bool valid_line = ss.good() || ss.eof();
+        unsigned int tenant = 0;
+        std::string tenant_column;
+        if (valid_line && ss >> tenant_column) {
+            // Digits only, so "-1" is rejected instead of wrapping around
+            valid_line = tenant_column.size() <= 2
+                && tenant_column.find_first_not_of("0123456789") == std::string::npos;
+            if (valid_line) {
+                tenant = static_cast<unsigned int>(std::stoul(tenant_column));
+                valid_line = tenant < MAX_TENANTS;
+            }
+        }
+        if (valid_line) {
+            trace.accesses.push_back({ op, address, tenant });
+        }
+        else {
+            std::cerr << "Warning: Skipping malformed line " << lines_read << ": '" << line << "'\n";
+        }
+    }
+    trace_file.close();
+    return true;
+}
+
+// Builds the result store key for a test case run against a trace
+std::string makeResultKey(const TestCase& test_case, unsigned long long trace_hash) {
+    const TranslationConfig& t = test_case.translation;
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << trace_hash << std::dec
+        << "|v" << SIMULATOR_VERSION
+        << "|" << test_case.cache_size
+        << "|" << test_case.block_size
+        << "|" << test_case.associativity
+        << "|" << test_case.replacement_policy
+        << "|" << t.page_size << "|" << t.mapping_policy << "|" << t.index_mode
+        << "|" << t.l1_tlb_entries << "|" << t.l1_tlb_associativity
+        << "|" << t.l2_tlb_entries << "|" << t.l2_tlb_associativity
+        << "|" << t.physical_address_bits << "|" << t.seed
+        << "|" << formatWayMasks(test_case.way_masks);
+    return key.str();
+}
+
+// Loads every stored result; a missing store file simply yields no results
+std::unordered_map<std::string, SimulationRecord> loadResultStore(const std::string& path) {
+    std::unordered_map<std::string, SimulationRecord> store;
+    std::ifstream store_file(path);
+    std::string line;
+    std::getline(store_file, line); // Skip the header
+    while (std::getline(store_file, line)) {
+        std::stringstream ss(line);
+        std::string key;
+        SimulationRecord record;
+        char comma;
+        if (!std::getline(ss, key, ',')) continue;
+        ss >> record.cache.hits >> comma >> record.cache.misses
+            >> comma >> record.translation.l1_tlb_hits >> comma >> record.translation.l1_tlb_misses
+            >> comma >> record.translation.l2_tlb_hits >> comma >> record.translation.l2_tlb_misses
+            >> comma >> record.translation.page_walks;
+        if (ss.fail()) {
+            std::cerr << "Warning: Ignoring malformed result store line: '" << line << "'\n";
+            continue;
+        }
+        // Per-tenant results: "hits/misses/occupancy" entries separated by ';'
+        std::string tenants;
+        if (ss >> comma && comma == ',' && std::getline(ss, tenants)) {
+            std::stringstream tenant_list(tenants);
+            std::string entry;
+            while (std::getline(tenant_list, entry, ';')) {
+                std::stringstream fields(entry);
+                TenantResults tenant;
+                char slash;
+                fields >> tenant.hits >> slash >> tenant.misses >> slash >> tenant.occupancy;
+                if (tenant.hits + tenant.misses > 0) {
+                    tenant.hit_rate = (double)tenant.hits / (tenant.hits + tenant.misses) * 100;
+                }
+                record.tenants.push_back(tenant);
+            }
+        }
+        if (record.cache.hits + record.cache.misses > 0) {
+            record.cache.hit_rate = (double)record.cache.hits / (record.cache.hits + record.cache.misses) * 100;
+        }
+        store[key] = record;
+    }
+    return store;
+}
+
+// Appends one result to the store and flushes it, so an interrupted run
+// keeps everything simulated so far
+void appendToResultStore(std::ofstream& store_file, const std::string& key, const SimulationRecord& record) {
+    store_file << key << ","
+        << record.cache.hits << ","
+        << record.cache.misses << ","
+        << record.translation.l1_tlb_hits << ","
+        << record.translation.l1_tlb_misses << ","
+        << record.translation.l2_tlb_hits << ","
+        << record.translation.l2_tlb_misses << ","
+        << record.translation.page_walks << ",";
+    for (size_t t = 0; t < record.tenants.size(); ++t) {
+        if (t > 0) store_file << ";";
+        store_file << record.tenants[t].hits << "/" << record.tenants[t].misses << "/" << record.tenants[t].occupancy;
+    }
+    store_file << "\n";
+    store_file.flush();
+}
+
+/*
+ * Synthetic workload generator. A test case whose trace file name has the
+ * form "gen:<name>" is driven by the WorkloadSpec called <name> instead of a
+ * trace file. Accesses are produced on the fly and fed straight into the
+ * cache. The same seed always yields the same stream on every machine: the
+ * generator uses its own PRNG rather than the implementation-defined <random>
+ * distributions, and the Zipf and mix weights are built in fixed-point
+ * integers instead of with libm or floating-point sums. Run "cache_simulator_exporter --write-trace <name> <file>" to save a
+ * workload in the trace file format instead.
+ */
+const std::string GENERATED_WORKLOAD_PREFIX = "gen:";
+
+// Bump this whenever the generated streams change for an unchanged spec
+const unsigned int GENERATOR_VERSION = 2;
+
+// A struct to describe one synthetic workload
+struct WorkloadSpec {
+    std::string name;
+    std::string pattern;                // 'stride', 'random', 'zipf', 'pointer_chase', 'matrix_tile' or 'mix'
+    unsigned long accesses = 0;         // Length of the stream
+    unsigned long base_address = 0x10000000;
+    unsigned long footprint = 1 << 20;  // Bytes covered by the pattern
+    unsigned int element_size = 8;      // Bytes per element, also the size written to trace files
+    unsigned long stride = 8;           // 'stride': bytes between consecutive accesses
+    double zipf_skew = 0.99;            // 'zipf': exponent of the popularity distribution
+    unsigned int matrix_dim = 128;      // 'matrix_tile': N of the three N x N matrices
+    unsigned int tile_dim = 16;         // 'matrix_tile': edge of a square tile
+    std::vector<std::pair<std::string, double>> mix; // 'mix': (workload name, weight)
+    double write_ratio = 0.0;           // Fraction of accesses that are stores (not used by 'mix' or 'matrix_tile')
+    unsigned long seed = 1;
+    unsigned int tenant = 0;            // Tenant the accesses belong to (a 'mix' keeps its components' tenants)
+};
+
+// Sequential walk over 'footprint' bytes, wrapping around at the end
+WorkloadSpec strideWorkload(const std::string& name, unsigned long accesses, unsigned long footprint,
+    unsigned long stride, double write_ratio, unsigned long seed) {
+    WorkloadSpec spec;
+    spec.name = name;
+    spec.pattern = "stride";
+    spec.accesses = accesses;
+    spec.footprint = footprint;
+    spec.stride = stride;
+    spec.write_ratio = write_ratio;
+    spec.seed = seed;
+    return spec;
+}
+
+// Uniformly random elements of 'footprint' bytes
+WorkloadSpec randomWorkload(const std::string& name, unsigned long accesses, unsigned long footprint,
+    double write_ratio, unsigned long seed) {
+    WorkloadSpec spec = strideWorkload(name, accesses, footprint, 8, write_ratio, seed);
+    spec.pattern = "random";
+    return spec;
+}
+
+// Zipf-distributed elements; the most popular elements form a hot set at the base address
+WorkloadSpec zipfWorkload(const std::string& name, unsigned long accesses, unsigned long footprint,
+    double skew, double write_ratio, unsigned long seed) {
+    WorkloadSpec spec = strideWorkload(name, accesses, footprint, 8, write_ratio, seed);
+    spec.pattern = "zipf";
+    spec.zipf_skew = skew;
+    return spec;
+}
+
+// Follows a random single-cycle linked list of 'node_size'-byte nodes
+WorkloadSpec pointerChaseWorkload(const std::string& name, unsigned long accesses, unsigned long footprint,
+    unsigned int node_size, double write_ratio, unsigned long seed) {
+    WorkloadSpec spec = strideWorkload(name, accesses, footprint, node_size, write_ratio, seed);
+    spec.pattern = "pointer_chase";
+    spec.element_size = node_size;
+    return spec;
+}
+
+// Tiled C += A * B over three N x N matrices of doubles: loads A[i][k] and
+// B[k][j], then stores C[i][j]
+WorkloadSpec matrixTileWorkload(const std::string& name, unsigned long accesses, unsigned int matrix_dim,
+    unsigned int tile_dim, unsigned long seed) {
+    WorkloadSpec spec = strideWorkload(name, accesses, 3UL * matrix_dim * matrix_dim * 8, 8, 0.0, seed);
+    spec.pattern = "matrix_tile";
+    spec.matrix_dim = matrix_dim;
+    spec.tile_dim = tile_dim;
+    return spec;
+}
+
+// Interleaves other workloads, picking each access from a component with
+// probability proportional to its weight
+WorkloadSpec mixWorkload(const std::string& name, unsigned long accesses,
+    const std::vector<std::pair<std::string, double>>& components, unsigned long seed) {
+    WorkloadSpec spec;
+    spec.name = name;
+    spec.pattern = "mix";
+    spec.accesses = accesses;
+    spec.mix = components;
+    spec.seed = seed;
+    return spec;
+}
+
+// Assigns a workload's accesses to a tenant of a shared cache, placing
+// them in the tenant's own address range
+WorkloadSpec withTenant(WorkloadSpec spec, unsigned int tenant, unsigned long base_address) {
+    spec.tenant = tenant;
+    spec.base_address = base_address;
+    return spec;
+}
+
+const WorkloadSpec* findWorkload(const std::vector<WorkloadSpec>& workloads, const std::string& name) {
+    for (const auto& workload : workloads) {
+        if (workload.name == name) return &workload;
+    }
+    return nullptr;
+}
+
+// splitmix64: small, fast and identical on every platform
+class WorkloadRng {
+private:
+    unsigned long long state;
+
+public:
+    explicit WorkloadRng(unsigned long long seed) : state(seed) {}
+
+    unsigned long long next() {
+        unsigned long long z = (state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Uniform double in [0, 1)
+    double uniform() {
+        return (next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    // Integer in [0, bound)
+    unsigned long long below(unsigned long long bound) {
+        return next() % bound;
+    }
+};
+
+// Fixed-point helpers for the Zipf weights. They use only integer arithmetic,
+// so the CDF is bit-identical on every compiler and math library.
+
+// log2(x) for x >= 1, in Q32 fixed point
+unsigned long long fixedLog2(unsigned long long x) {
+    unsigned int integer_part = 0;
+    while ((x >> (integer_part + 1)) != 0) integer_part++;
+    // Mantissa in [1, 2) as Q31; squaring it reveals one fraction bit per step
+    unsigned long long mantissa = (integer_part >= 31) ? (x >> (integer_part - 31)) : (x << (31 - integer_part));
+    unsigned long long fraction = 0;
+    for (int bit = 31; bit >= 0; --bit) {
+        mantissa = (mantissa * mantissa) >> 31;
+        if (mantissa >= (1ULL << 32)) {
+            mantissa >>= 1;
+            fraction |= 1ULL << bit;
+        }
+    }
+    return (static_cast<unsigned long long>(integer_part) << 32) | fraction;
+}
+
+// 2^(-2^-i) in Q31 for i = 1..32
+const unsigned long long EXP2_NEGATIVE_POWERS[32] = {
+    1518500250, 1805811301, 1969251188, 2056437387, 2101467502, 2124350982, 2135885998, 2141676973,
+    2144578345, 2146030505, 2146756953, 2147120270, 2147301951, 2147392798, 2147438222, 2147460935,
+    2147472292, 2147477970, 2147480809, 2147482228, 2147482938, 2147483293, 2147483471, 2147483559,
+    2147483604, 2147483626, 2147483637, 2147483642, 2147483645, 2147483647, 2147483647, 2147483648
+};
+
+// rank^(-skew) scaled by 2^32, with the skew in Q16 fixed point. Never
+// returns 0, so every element stays reachable.
+unsigned long long zipfWeight(unsigned long long rank, unsigned long long skew_q16) {
+    unsigned long long exponent = (skew_q16 * fixedLog2(rank)) >> 16; // Q32
+    unsigned long long integer_part = exponent >> 32;
+    unsigned long long weight = 1ULL << 31; // 1.0 in Q31
+    for (int i = 1; i <= 32; ++i) {
+        if ((exponent >> (32 - i)) & 1) {
+            weight = (weight * EXP2_NEGATIVE_POWERS[i - 1]) >> 31;
+        }
+    }
+    weight = (integer_part >= 33) ? 0 : ((weight << 1) >> integer_part);
+    return weight == 0 ? 1 : weight;
+}
+
+// Produces the access stream described by a WorkloadSpec
+class WorkloadGenerator {
+private:
+    WorkloadSpec spec;
+    WorkloadRng rng;
+    unsigned long produced = 0;
+    unsigned long elements = 0;
+
+    unsigned long offset = 0;                 // 'stride'
+    std::vector<unsigned long long> zipf_cdf; // 'zipf': running sum of zipfWeight
+    std::vector<unsigned long> next_node;     // 'pointer_chase'
+    unsigned long current_node = 0;
+    unsigned int ii = 0, jj = 0, kk = 0;      // 'matrix_tile': tile origin
+    unsigned int i = 0, j = 0, k = 0;         // 'matrix_tile': position inside the tile
+    unsigned int matrix_phase = 0;            // 'matrix_tile': 0 = A[i][k], 1 = B[k][j], 2 = C[i][j]
+    std::vector<WorkloadGenerator> components; // 'mix'
+    std::vector<unsigned long long> component_cdf; // 'mix': running sum of Q16 weights
+
+    bool is_valid = true;
+
+    void advanceMatrix() {
+        unsigned int n = spec.matrix_dim;
+        unsigned int t = spec.tile_dim;
+        if (++k < t) return;
+        k = 0;
+        if (++j < t) return;
+        j = 0;
+        if (++i < t) return;
+        i = 0;
+        if ((kk += t) < n) return;
+        kk = 0;
+        if ((jj += t) < n) return;
+        jj = 0;
+        if ((ii += t) < n) return;
+        ii = 0; // Start the multiplication over
+    }
+
+    unsigned long nextAddress() {
+        if (spec.pattern == "stride") {
+            unsigned long address = spec.base_address + offset;
+            offset = (offset + spec.stride) % spec.footprint;
+            return address;
+        }
+        if (spec.pattern == "random") {
+            return spec.base_address + rng.below(elements) * spec.element_size;
+        }
+        if (spec.pattern == "zipf") {
+            unsigned long long u = rng.below(zipf_cdf.back());
+            unsigned long rank = static_cast<unsigned long>(
+                std::upper_bound(zipf_cdf.begin(), zipf_cdf.end(), u) - zipf_cdf.begin());
+            if (rank >= elements) rank = elements - 1;
+            return spec.base_address + rank * spec.element_size;
+        }
+        if (spec.pattern == "pointer_chase") {
+            current_node = next_node[current_node];
+            return spec.base_address + current_node * spec.element_size;
+        }
+        // matrix_tile
+        unsigned long n = spec.matrix_dim;
+        unsigned long matrix_bytes = n * n * 8;
+        unsigned long row = 0, column = 0, matrix = matrix_phase;
+        if (matrix_phase == 0) { row = ii + i; column = kk + k; }
+        else if (matrix_phase == 1) { row = kk + k; column = jj + j; }
+        else { row = ii + i; column = jj + j; }
+        if (++matrix_phase == 3) {
+            matrix_phase = 0;
+            advanceMatrix();
+        }
+        return spec.base_address + matrix * matrix_bytes + (row * n + column) * 8;
+    }
+
+    // One access of an endless stream; next() applies the stream length
+    TraceAccess produce() {
+        if (spec.pattern == "mix") {
+            unsigned long long u = rng.below(component_cdf.back());
+            size_t c = std::upper_bound(component_cdf.begin(), component_cdf.end(), u) - component_cdf.begin();
+            if (c >= components.size()) c = components.size() - 1;
+            return components[c].produce();
+        }
+        if (spec.pattern == "matrix_tile") {
+            char op = (matrix_phase == 2) ? 's' : 'l';
+            return { op, nextAddress(), spec.tenant };
+        }
+        unsigned long address = nextAddress();
+        char op = rng.uniform() < spec.write_ratio ? 's' : 'l';
+        return { op, address, spec.tenant };
+    }
+
+public:
+    WorkloadGenerator(const WorkloadSpec& ws, const std::vector<WorkloadSpec>& workloads, unsigned int depth = 0)
+        : spec(ws), rng(ws.seed) {
+
+        if (spec.tenant >= MAX_TENANTS) {
+            std::cerr << "Error: Workload '" << spec.name << "' uses tenant " << spec.tenant
+                << ", but tenants must be below " << MAX_TENANTS << ".\n";
+            is_valid = false;
+            return;
+        }
+
+        if (spec.pattern == "mix") {
+            if (depth > 8 || spec.mix.empty()) {
+                std::cerr << "Error: Mixed workload '" << spec.name << "' must list components and cannot nest more than 8 deep.\n";
+                is_valid = false;
+                return;
+            }
+            unsigned long long total_weight = 0;
+            for (const auto& component : spec.mix) {
+                const WorkloadSpec* component_spec = findWorkload(workloads, component.first);
+                // Weights are used in Q16 fixed point
+                unsigned long long weight_q16 = (component.second > 0.0 && component.second < 65536.0)
+                    ? static_cast<unsigned long long>(component.second * 65536.0) : 0;
+                if (component_spec == nullptr || weight_q16 == 0) {
+                    std::cerr << "Error: Mixed workload '" << spec.name << "' has an unknown or zero-weight component '"
+                        << component.first << "'.\n";
+                    is_valid = false;
+                    return;
+                }
+                components.emplace_back(*component_spec, workloads, depth + 1);
+                if (!components.back().is_generator_valid()) {
+                    is_valid = false;
+                    return;
+                }
+                total_weight += weight_q16;
+                component_cdf.push_back(total_weight);
+            }
+            return;
+        }
+
+        if (spec.element_size == 0 || spec.footprint < spec.element_size) {
+            std::cerr << "Error: Workload '" << spec.name << "' needs a footprint of at least one non-zero element.\n";
+            is_valid = false;
+            return;
+        }
+        elements = spec.footprint / spec.element_size;
+
+        if (spec.pattern == "stride") {
+            if (spec.stride == 0) {
+                std::cerr << "Error: Workload '" << spec.name << "' needs a non-zero stride.\n";
+                is_valid = false;
+            }
+        }
+        else if (spec.pattern == "random") {
+            // No precomputed state
+        }
+        else if (spec.pattern == "zipf") {
+            // The skew is used in Q16 fixed point, and weights are at most 2^32,
+            // so the running sum fits in 64 bits for up to 2^31 elements
+            if (!(spec.zipf_skew >= 0.0 && spec.zipf_skew < 16.0) || elements > (1UL << 31)) {
+                std::cerr << "Error: Workload '" << spec.name << "' needs a Zipf skew in [0, 16) and at most 2^31 elements.\n";
+                is_valid = false;
+                return;
+            }
+            unsigned long long skew_q16 = static_cast<unsigned long long>(spec.zipf_skew * 65536.0);
+            // Precompute the CDF once so each access is a binary search
+            zipf_cdf.resize(elements);
+            unsigned long long total = 0;
+            for (unsigned long rank = 0; rank < elements; ++rank) {
+                total += zipfWeight(rank + 1, skew_q16);
+                zipf_cdf[rank] = total;
+            }
+        }
+        else if (spec.pattern == "pointer_chase") {
+            // Sattolo's algorithm: a random permutation that is one single cycle,
+            // so the chase visits every node before repeating
+            next_node.resize(elements);
+            for (unsigned long n = 0; n < elements; ++n) next_node[n] = n;
+            for (unsigned long n = elements - 1; n > 0; --n) {
+                std::swap(next_node[n], next_node[rng.below(n)]);
+            }
+        }
+        else if (spec.pattern == "matrix_tile") {
+            if (spec.matrix_dim == 0 || spec.tile_dim == 0 || spec.matrix_dim % spec.tile_dim != 0) {
+                std::cerr << "Error: Workload '" << spec.name << "' needs a matrix size that is a multiple of the tile size.\n";
+                is_valid = false;
+            }
+        }
+        else {
+            std::cerr << "Error: Unknown workload pattern '" << spec.pattern << "' in workload '" << spec.name << "'.\n";
+            is_valid = false;
+        }
+    }
+
+    bool is_generator_valid() const {
+        return is_valid;
+    }
+
+    // Writes the next access to 'access'; returns false at the end of the stream
+    bool next(TraceAccess& access) {
+        if (produced >= spec.accesses) return false;
+        produced++;
+        access = produce();
+        return true;
+    }
+};
+
+// Fingerprints a workload (including the specs of its mix components) so
+// the result store can recognise unchanged generated workloads
+unsigned long long hashWorkload(const WorkloadSpec& spec, const std::vector<WorkloadSpec>& workloads,
+    unsigned int depth = 0) {
+    std::stringstream description;
+    description << "generator-v" << GENERATOR_VERSION << "|" << spec.pattern << "|" << spec.accesses
+        << "|" << spec.base_address << "|" << spec.footprint << "|" << spec.element_size
+        << "|" << spec.stride << "|" << std::setprecision(17) << spec.zipf_skew
+        << "|" << spec.matrix_dim << "|" << spec.tile_dim << "|" << spec.write_ratio << "|" << spec.seed << "|" << spec.tenant;
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    std::string text = description.str();
+    hash = hashBytes(hash, text.data(), text.size());
+    for (const auto& component : spec.mix) {
+        std::stringstream weight;
+        weight << "|" << component.first << "=" << std::setprecision(17) << component.second;
+        hash = hashBytes(hash, weight.str().data(), weight.str().size());
+        const WorkloadSpec* component_spec = findWorkload(workloads, component.first);
+        if (component_spec != nullptr && depth < 8) {
+            unsigned long long component_hash = hashWorkload(*component_spec, workloads, depth + 1);
+            hash = hashBytes(hash, reinterpret_cast<const char*>(&component_hash), sizeof(component_hash));
+        }
+    }
+    return hash;
+}
+
+// Writes a workload in the "<l|s> 0x<address> <size> [tenant]" trace file
+// format; the tenant column is only written for tenants other than 0
+bool writeWorkloadTrace(const WorkloadSpec& spec, const std::vector<WorkloadSpec>& workloads,
+    const std::string& filename) {
+    WorkloadGenerator generator(spec, workloads);
+    if (!generator.is_generator_valid()) return false;
+
+    std::ofstream file(filename, std::ios_base::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not create trace file " << filename << "\n";
+        return false;
+    }
+    TraceAccess access;
+    while (generator.next(access)) {
+        file << access.op << " 0x" << std::hex << std::uppercase << std::setw(8) << std::setfill('0')
+            << access.address << std::dec << " " << spec.element_size;
+        if (access.tenant != 0) {
+            file << " " << access.tenant;
+        }
+        file << "\n";
+    }
+    file.close();
+    std::cout << "Workload '" << spec.name << "' written to " << filename << "\n";
+    return true;
+}
+
 // Main function to run all simulations
-int main() {
+int main(int argc, char* argv[]) {
+    // Synthetic workloads that test cases can use as "gen:<name>"
+    std::vector<WorkloadSpec> workloads = {
+        strideWorkload("stride-64", 300000, 64 * 1024, 64, 0.3, 1),
+        randomWorkload("random-1mb", 300000, 1 << 20, 0.3, 2),
+        zipfWorkload("zipf-hot", 300000, 1 << 20, 0.99, 0.2, 3),
+        pointerChaseWorkload("list-chase", 300000, 256 * 1024, 64, 0.0, 4),
+        matrixTileWorkload("matmul-tiled", 300000, 128, 16, 5),
+        mixWorkload("service-mix", 300000, { {"zipf-hot", 0.6}, {"list-chase", 0.3}, {"stride-64", 0.1} }, 6),
+
+        // Two co-located tenants: a latency-sensitive hot set and a streaming
+        // neighbour. The hot set is as large as the whole 16 KB cache, so its
+        // hit rate grows with every way it is given.
+        withTenant(zipfWorkload("tenant0-hot-set", 0, 16 * 1024, 0.8, 0.2, 7), 0, 0x10000000),
+        withTenant(strideWorkload("tenant1-stream", 0, 4 << 20, 64, 0.5, 8), 1, 0x20000000),
+        mixWorkload("colocated", 300000, { {"tenant0-hot-set", 0.5}, {"tenant1-stream", 0.5} }, 9)
+    };
+
+    if (argc == 4 && std::string(argv[1]) == "--write-trace") {
+        const WorkloadSpec* workload = findWorkload(workloads, argv[2]);
+        if (workload == nullptr) {
+            std::cerr << "Error: Unknown workload '" << argv[2] << "'.\n";
+            return 1;
+        }
+        return writeWorkloadTrace(*workload, workloads, argv[3]) ? 0 : 1;
+    }
+
     std::vector<TestCase> test_cases = {
         // --- swim.trace with LRU ---
         {1024, 64, 1, "lru", "swim.trace"},
@@ -356,7 +1442,30 @@ int main() {
         {16384, 64, 4, "lru", "read05.trace"},
         {1024, 16, 1, "fifo", "read06.trace"},
         {2048, 64, 8, "lru", "read08.trace"},
-        {4096, 64, 4, "fifo", "write01.trace"}
+        {4096, 64, 4, "fifo", "write01.trace"},
+
+        // --- swim.trace behind the TLB: page size, frame mapping and cache indexing ---
+        {16384, 64, 1, "lru", "swim.trace", {4096, "random", "physical"}},
+        {16384, 64, 1, "lru", "swim.trace", {4096, "coloring", "physical"}},
+        {16384, 64, 1, "lru", "swim.trace", {4096, "random", "virtual"}},
+        {16384, 64, 1, "lru", "swim.trace", {2097152, "random", "physical"}},
+        {16384, 64, 1, "lru", "swim.trace", {1073741824, "random", "physical"}},
+
+        // --- Synthetic workloads ---
+        {16384, 64, 4, "lru", "gen:stride-64"},
+        {16384, 64, 4, "lru", "gen:random-1mb"},
+        {16384, 64, 4, "lru", "gen:zipf-hot"},
+        {16384, 64, 4, "fifo", "gen:zipf-hot"},
+        {16384, 64, 4, "lru", "gen:list-chase"},
+        {16384, 64, 4, "lru", "gen:matmul-tiled"},
+        {16384, 64, 4, "lru", "gen:service-mix"},
+
+        // --- Way partitioning of a shared cache between two tenants ---
+        {16384, 64, 8, "lru", "gen:colocated"},
+        {16384, 64, 8, "lru", "gen:colocated", {}, {0x0F, 0xF0}},
+        {16384, 64, 8, "lru", "gen:colocated", {}, {0x3F, 0xC0}},
+        {16384, 64, 8, "lru", "gen:colocated", {}, {0x7F, 0x80}},
+        {16384, 64, 8, "fifo", "gen:colocated", {}, {0x3F, 0xC0}}
     };
 
     system("mkdir Exports");
@@ -367,7 +1476,34 @@ int main() {
             << "Please check file permissions.\n";
         return 1;
     }
-    output_file << "Policy,Associativity,CacheSize,BlockSize,Hits,Misses,HitRate,TraceFile\n";
+    output_file << "Policy,Associativity,CacheSize,BlockSize,Hits,Misses,HitRate,TraceFile,"
+        << "PageSize,PageMapping,CacheIndexing,L1TlbHits,L1TlbMisses,L2TlbHits,L2TlbMisses,PageWalks,WayMasks\n";
+
+    // Per-tenant results of traces with several tenants or partitioned caches
+    std::ofstream tenant_file("Exports/tenant_results.csv", std::ios_base::trunc);
+    if (!tenant_file.is_open()) {
+        std::cerr << "Error: Could not create output file Exports/tenant_results.csv. "
+            << "Please check file permissions.\n";
+        return 1;
+    }
+    tenant_file << "Policy,Associativity,CacheSize,BlockSize,TraceFile,Tenant,WayMask,Hits,Misses,HitRate,Occupancy\n";
+
+    bool store_exists = std::ifstream(RESULT_STORE_PATH).good();
+    std::unordered_map<std::string, SimulationRecord> result_store = loadResultStore(RESULT_STORE_PATH);
+    std::ofstream store_file(RESULT_STORE_PATH, std::ios_base::app);
+    if (!store_file.is_open()) {
+        std::cerr << "Warning: Could not open " << RESULT_STORE_PATH << ". New results will not be stored.\n";
+    }
+    else if (!store_exists) {
+        store_file << "Key,Hits,Misses,L1TlbHits,L1TlbMisses,L2TlbHits,L2TlbMisses,PageWalks,Tenants\n";
+    }
+    std::cout << "Loaded " << result_store.size() << " stored results from " << RESULT_STORE_PATH << "\n";
+
+    // Only the most recently used trace is kept in memory; test cases are
+    // grouped by trace file, so each trace is read once.
+    LoadedTrace trace;
+    unsigned int simulated = 0;
+    unsigned int reused = 0;
 
     for (const auto& test_case : test_cases) {
         std::cout << "------------------------------------\n";
@@ -377,6 +1513,9 @@ int main() {
         std::cout << " - Block Size: " << test_case.block_size << " bytes\n";
         std::cout << " - Associativity: " << test_case.associativity << "-way\n";
         std::cout << " - Trace File: " << test_case.trace_filename << "\n";
+        std::cout << " - Page Size: " << test_case.translation.page_size << " bytes ("
+            << test_case.translation.mapping_policy << " mapping, "
+            << test_case.translation.index_mode << " indexing)\n";
         std::cout << "------------------------------------\n";
 
         Cache cache_simulator(test_case.cache_size,
@@ -384,44 +1523,95 @@ int main() {
             test_case.associativity,
             test_case.replacement_policy);
 
+        cache_simulator.set_way_masks(test_case.way_masks);
         if (!cache_simulator.is_cache_valid()) {
             std::cout << "Skipping this invalid configuration.\n";
             continue;
         }
 
-        std::ifstream trace_file(test_case.trace_filename);
-        if (!trace_file.is_open()) {
-            std::cerr << "Error: Could not open trace file '" << test_case.trace_filename << "'. Please ensure the file exists and is in the current working directory.\n";
+        AddressTranslator translator(test_case.translation, test_case.cache_size, test_case.associativity);
+        if (!translator.is_translator_valid()) {
+            std::cout << "Skipping this invalid translation configuration.\n";
             continue;
         }
 
-        char op;
-        unsigned long address;
-        unsigned int size;
-        std::string line;
-        unsigned int lines_read = 0;
-        unsigned int successful_accesses = 0;
-        while (std::getline(trace_file, line)) {
-            lines_read++;
-            if (line.empty()) continue;
-            std::stringstream ss(line);
-            ss >> op >> std::hex >> address >> size;
-            if (ss.good() || ss.eof()) {
-                cache_simulator.access(op, address);
-                successful_accesses++;
+        // Generated workloads are identified by their spec, trace files by their contents
+        const WorkloadSpec* workload = nullptr;
+        unsigned long long source_hash = 0;
+        if (test_case.trace_filename.compare(0, GENERATED_WORKLOAD_PREFIX.size(), GENERATED_WORKLOAD_PREFIX) == 0) {
+            workload = findWorkload(workloads, test_case.trace_filename.substr(GENERATED_WORKLOAD_PREFIX.size()));
+            if (workload == nullptr) {
+                std::cerr << "Error: Unknown generated workload '" << test_case.trace_filename << "'.\n";
+                continue;
+            }
+            source_hash = hashWorkload(*workload, workloads);
+        }
+        else {
+            if (trace.filename != test_case.trace_filename && !loadTrace(test_case.trace_filename, trace)) {
+                std::cerr << "Error: Could not open trace file '" << test_case.trace_filename << "'. Please ensure the file exists and is in the current working directory.\n";
+                continue;
+            }
+            source_hash = trace.hash;
+        }
+
+        std::string key = makeResultKey(test_case, source_hash);
+        SimulationRecord record;
+        auto stored = result_store.find(key);
+        if (stored != result_store.end()) {
+            record = stored->second;
+            reused++;
+            std::cout << "Trace and configuration unchanged; using stored results.\n";
+        }
+        else {
+            auto simulate = [&](const TraceAccess& trace_access) {
+                unsigned long address = trace_access.address;
+                // Only loads and stores are translated; Cache ignores everything else
+                if (trace_access.op == 'l' || trace_access.op == 's') {
+                    address = translator.translate(address);
+                }
+                cache_simulator.access(trace_access.op, address, trace_access.tenant);
+            };
+
+            if (workload != nullptr) {
+                WorkloadGenerator generator(*workload, workloads);
+                if (!generator.is_generator_valid()) {
+                    std::cout << "Skipping this invalid workload.\n";
+                    continue;
+                }
+                TraceAccess generated;
+                while (generator.next(generated)) {
+                    simulate(generated);
+                }
             }
             else {
-                std::cerr << "Warning: Skipping malformed line " << lines_read << ": '" << line << "'\n";
+                for (const TraceAccess& trace_access : trace.accesses) {
+                    simulate(trace_access);
+                }
+            }
+            if (!translator.is_translator_valid()) {
+                std::cout << "Skipping this configuration: the translation stage ran out of physical frames.\n";
+                continue;
             }
+            record = { cache_simulator.get_results(), translator.get_results(), cache_simulator.get_tenant_results() };
+            result_store[key] = record;
+            if (store_file.is_open()) {
+                appendToResultStore(store_file, key, record);
+            }
+            simulated++;
         }
-        trace_file.close();
 
-        writeResultToCSV(output_file, cache_simulator, test_case.trace_filename);
+        writeResultToCSV(output_file, test_case, record);
+        if (record.tenants.size() > 1 || !test_case.way_masks.empty()) {
+            writeTenantResultsToCSV(tenant_file, test_case, record);
+        }
         std::cout << "Results appended to all_results.csv\n";
     }
 
     output_file.close();
-    std::cout << "\nAll simulations have been completed. Check the 'Exports' folder for your single CSV file.\n";
+    tenant_file.close();
+    store_file.close();
+    std::cout << "\n" << simulated << " configurations simulated, " << reused << " reused from " << RESULT_STORE_PATH << ".\n";
+    std::cout << "All simulations have been completed. Check the 'Exports' folder for your single CSV file.\n";
     std::cout << "If the program still failed, please check the console for specific error messages.\n";
 
     return 0;